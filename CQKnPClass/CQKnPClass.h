@@ -45,6 +45,15 @@
 /**< If CQKnPClass_LOG > 0, data structures and methods to log the activities
    of the (actual) solver are added to the (abstract) interface. */
 
+#define CQKnPClass_PARALLEL 1
+
+/**< If CQKnPClass_PARALLEL == 1, ReadInstance( const char * ) parses large
+   files with multiple threads. This requires C++11 std::thread, and the
+   corresponding linker flags (-pthread) are added by the makefile. If
+   CQKnPClass_PARALLEL == 0, the file is parsed by the calling thread only.
+   Either way, the readers of files are in CQKnPRead.C, which is compiled
+   with -std=c++17 for std::from_chars(). */
+
 /*@}  end( group( CQKnPClass_MACROS ) ) */ 
 /*--------------------------------------------------------------------------*/
 /*------------------------------ INCLUDES ----------------------------------*/
@@ -52,8 +61,11 @@
 
 #include <limits>
 #include <exception>
+#include <algorithm>
 
 #include <iostream>
+#include <cstring>
+#include <stdint.h>
 
 /*--------------------------------------------------------------------------*/
 /*------------------------- NAMESPACE and USING ----------------------------*/
@@ -157,6 +169,23 @@ class CQKnPClass {
      operator T() { return( std::numeric_limits<T>::max() ); }
     };
 
+/*--------------------------------------------------------------------------*/
+/** The header of a file in the binary format of ReadInstanceBinary() and
+    WriteInstanceBinary() [see below]. It is followed by the n-vectors of
+    the linear costs, the quadratic costs, the lower bounds and the upper
+    bounds, in this order, each one a block of n doubles starting at offset
+    Off[ 0 ], ..., Off[ 3 ] from the beginning of the file. All the numbers
+    are in the byte order of the machine that wrote the file. */
+
+   struct BinHeader {
+    char Magic[ 8 ];    ///< always "CQKnPBin" (no terminating 0)
+    uint32_t Version;   ///< the version of the format, now 1
+    uint32_t Sense;     ///< 1 for an equality constraint, 0 for <=
+    uint64_t n;         ///< the number of items
+    double V;           ///< the volume of the knapsack
+    uint64_t Off[ 4 ];  ///< the offsets of C[], D[], A[] and B[]
+    };
+
 /*@} -----------------------------------------------------------------------*/
 /*--------------------------- PUBLIC METHODS -------------------------------*/
 /*--------------------------------------------------------------------------*/
@@ -258,6 +287,65 @@ class CQKnPClass {
    latter is invoked inside), so the object is "ready to use" once this method
    returns. */
 
+/*--------------------------------------------------------------------------*/
+
+   virtual void ReadInstance( const char *fName , bool RBV = false ,
+			      int nthr = 0 );
+
+/**< Same as ReadInstance( std::istream & ) [see above], but the instance is
+   read from the file with name fName, which is mapped in memory and parsed
+   with std::from_chars() rather than with the (locale-aware) operator>>.
+   The file is split in chunks which are parsed by nthr threads at the same
+   time (0 means as many as the hardware ones, and in any case there is no
+   more than one for each MB of the file). The result is the same as with
+   the other version: in particular, any number whose absolute value is not
+   smaller than Inf<double>() (as the one written by WriteInstance() for an
+   infinite bound) means +/- INF; so do the numbers too large for a double
+   and, which operator>> does not accept, "inf" and "infinity" (in any
+   case). Data after the last required number is ignored, as with the
+   other version, while anything which is not a number before that throws
+   CQKException (rather than stopping the reading). */
+
+/*--------------------------------------------------------------------------*/
+
+   virtual void ReadInstanceBinary( const char *fName );
+
+/**< Read the instance from the file with name fName, which must be in the
+   binary format written by WriteInstanceBinary() [see below]. The file is
+   mapped in memory rather than parsed, and the data is checked as in
+   ReadInstance() [see above].
+
+   While virtual, the method is implemented in the base class by calling
+   LoadSet() with pointers inside the mapped file, which is released right
+   after. Derived classes which can read the data from the caller's memory
+   (see DualCQKnP::LoadView()) re-implement it so that the data is not
+   copied at all, and the file is released only when it is no longer
+   used. */
+
+/*--------------------------------------------------------------------------*/
+
+   static bool IsBinaryInstance( const char *fName );
+
+/**< Returns true if the file with name fName exists and it starts as the
+   ones written by WriteInstanceBinary() [see below]. */
+
+/*--------------------------------------------------------------------------*/
+
+   static inline bool IsBlnk( const char c )
+   {
+    return( ( c == ' ' ) | ( (unsigned char)( c - '\t' ) <= '\r' - '\t' ) );
+    }
+
+   static const char *ParseNum( const char *p , const char *e , double &x );
+
+/**< Utilities for reading the text format, used by ReadInstance( const char
+   * ) [see above] and by whatever else reads it. IsBlnk() tells if c
+   separates two numbers (as isspace() does in the "C" locale). ParseNum()
+   reads in x the number starting at p (and ending before e), returning
+   where it ends, or 0 if it is not a number; what it accepts, and the
+   meaning of the numbers which are too large, is described in
+   ReadInstance( const char * ). */
+
 /*--------------------------------------------------------------------------*/
 
 #if CQKnPClass_LOG
@@ -317,6 +405,27 @@ class CQKnPClass {
 		  solver-dependent ways of dealing with solver-dependent
 		  errors may exhist. */
 
+/*--------------------------------------------------------------------------*/
+
+   virtual inline void SolveVlms( const int m , const double *Vlms ,
+				  double *Pi = 0 , double *FO = 0 ,
+				  CQKStatus *Stt = 0 );
+
+/**< Solves the current CQKnP instance for each one of the m volumes in
+   Vlms[], writing in Pi[ i ], FO[ i ] and Stt[ i ] what KNPGetPi(),
+   KNPGetFO() and SolveKNP() would return if the volume were Vlms[ i ];
+   any of Pi, FO and Stt can be 0 if that information is not needed. As
+   for KNPGetFO(), FO[ i ] is INF if Stt[ i ] == kUnfeasible and - INF if
+   Stt[ i ] == kUnbounded, while Pi[ i ] is only meaningful if
+   Stt[ i ] == kOK.
+
+   While virtual, the method is implemented in the base class by calling
+   ChgVlm() and SolveKNP() for each volume, and then restoring the original
+   volume with ChgVlm(); hence, SolveKNP() has to be called again before the
+   solution of the current instance can be read. Derived classes can
+   re-implement it much more efficiently, and without affecting the current
+   solution. */
+
 /*--------------------------------------------------------------------------*/
 /*---------------------- METHODS FOR READING RESULTS -----------------------*/
 /*--------------------------------------------------------------------------*/
@@ -327,6 +436,20 @@ class CQKnPClass {
    CheckFsb() == true, see above), which is optimal if SolveKNP() has
    returned kOK (see above). */
 
+   virtual inline void KNPGetX( double *x , const int *nms = 0 ,
+				int strt = 0 , int stp = Inf<int>() );
+
+/**< Writes into x[] the components of the solution returned by KNPGetX()
+   for the items selected by nms, strt and stp, with the same meaning as in
+   KNPLCosts() (see below).
+
+   While virtual, the method is implemented in the base class by calling
+   KNPGetX() and copying the required components. Derived classes can
+   re-implement it computing only those, which is much cheaper than
+   computing the whole solution when they are few. Note that a derived
+   class redefining only one of the two versions of KNPGetX() hides the
+   other, unless it brings it in scope with a using-declaration. */
+
 /*--------------------------------------------------------------------------*/
 
    virtual double KNPGetPi( void ) = 0;
@@ -487,6 +610,23 @@ class CQKnPClass {
    derived class with no mdification; however, being virtual it can be
    re-implemented for maximum efficiency if desired. */
 
+/*--------------------------------------------------------------------------*/
+
+   virtual inline void WriteInstanceBinary( std::ostream &oFile ,
+					    const bool sns = true );
+
+/**< Write the instance to the provided ostream, which must have been opened
+   in binary mode, in the format read by ReadInstanceBinary() [see above]:
+   a BinHeader [see above] followed by the four n-vectors of the data, each
+   one starting at a multiple of 64 bytes (hence, at the beginning of a
+   cache line when the file is mapped in memory). All the digits of the
+   data are kept. Since the sense of the knapsack constraint cannot be read
+   from the object, it has to be given in sns as in LoadSet().
+
+   As WriteInstance(), the method reads the data from the object using the
+   class-provided implementation of KNPLCosts() and so on, a few thousands
+   items at a time. */
+
 /*--------------------------------------------------------------------------*/
 /*------------- METHODS FOR CHANGING THE DATA OF THE PROBLEM ---------------*/
 /*--------------------------------------------------------------------------*/
@@ -614,6 +754,40 @@ class CQKnPClass {
 
  protected:
 
+/*--------------------------------------------------------------------------*/
+/*--------------------------- PROTECTED METHODS ----------------------------*/
+/*--------------------------------------------------------------------------*/
+
+ static const BinHeader *MapBinary( const char *fName , size_t &len );
+
+/**< Maps the file with name fName in memory, read-only, and checks that it
+   is a correct instance in the binary format [see ReadInstanceBinary()];
+   the length of the file is written in len. If anything is wrong, the file
+   is released and CQKException is thrown. */
+
+ static void UnMapBinary( const BinHeader *hdr , const size_t len );
+
+/**< Releases a file mapped in memory by MapBinary(). */
+
+ static inline const double *BinData( const BinHeader *hdr , const int k )
+ {
+  const char *mem = reinterpret_cast< const char * >( hdr );
+  return( reinterpret_cast< const double * >( mem + hdr->Off[ k ] ) );
+  }
+
+/**< Returns a pointer to the k-th n-vector of a file mapped by MapBinary(),
+   where k = 0, 1, 2, 3 for C[], D[], A[] and B[], respectively. */
+
+ static int CountNums( const char *p , const char *e );
+
+ static const char *ParseNums( const char *p , const char *e ,
+				int j , const int nv , double *val );
+
+/**< The parts of ReadInstance( const char * ): CountNums() returns how many
+   numbers there are in [ p , e ), and ParseNums() reads them in
+   val[ j - 1 ], val[ j ], ..., stopping at val[ nv - 1 ]; it returns 0 if
+   all of them are numbers, and an error message otherwise. */
+
 /*--------------------------------------------------------------------------*/
 /*---------------------- PROTECTED DATA STRUCTURES  ------------------------*/
 /*--------------------------------------------------------------------------*/
@@ -704,6 +878,61 @@ inline void CQKnPClass::ReadInstance( std::istream &inFile , bool RBV )
 
 /*--------------------------------------------------------------------------*/
 
+inline void CQKnPClass::SolveVlms( const int m , const double *Vlms ,
+				   double *Pi , double *FO , CQKStatus *Stt )
+{
+ const double V = KNPVlm();
+
+ for( int i = 0 ; i < m ; i++ ) {
+  ChgVlm( Vlms[ i ] );
+  const CQKStatus st = SolveKNP();
+
+  if( Stt )
+   Stt[ i ] = st;
+
+  if( Pi )
+   Pi[ i ] = KNPGetPi();
+
+  if( FO )
+   switch( st ) {
+    case( kOK ):         FO[ i ] = KNPGetFO(); break;
+    case( kUnbounded ):  FO[ i ] = - Inf<double>(); break;
+    default:             FO[ i ] = Inf<double>();
+    }
+  }
+
+ ChgVlm( V );
+
+ }  // end( SolveVlms )
+
+/*--------------------------------------------------------------------------*/
+
+inline void CQKnPClass::KNPGetX( double *x , const int *nms ,
+				 int strt , int stp )
+{
+ const double *X = KNPGetX();
+
+ if( stp > n )
+  stp = n;
+
+ if( strt < 0 )
+  strt = 0;
+
+ if( nms ) {
+  while( *nms < strt )
+   nms++;
+
+  for( int i ; ( i = *( nms++ ) ) < stp ; )
+   *x++ = X[ i ];
+  }
+ else
+  for( int i = strt ; i < stp ; i++ )
+   *x++ = X[ i ];
+
+ }  // end( KNPGetX )
+
+/*--------------------------------------------------------------------------*/
+
 inline void CQKnPClass::WriteInstance( std::ostream &oFile ,
 				       const int precc , const int precv )
 {
@@ -733,6 +962,56 @@ inline void CQKnPClass::WriteInstance( std::ostream &oFile ,
 
  }  // end( WriteInstance )
 
+/*--------------------------------------------------------------------------*/
+
+inline void CQKnPClass::WriteInstanceBinary( std::ostream &oFile ,
+					     const bool sns )
+{
+ // write the header- - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ // each n-vector takes a multiple of 64 bytes, and the header 64 bytes
+
+ const uint64_t lClmn = ( ( n * sizeof( double ) + 63 ) / 64 ) * 64;
+
+ BinHeader hdr;
+ std::memset( &hdr , 0 , sizeof( BinHeader ) );
+ std::memcpy( hdr.Magic , "CQKnPBin" , 8 );
+ hdr.Version = 1;
+ hdr.Sense = sns;
+ hdr.n = n;
+ hdr.V = KNPVlm();
+ for( int k = 0 ; k < 4 ; k++ )
+  hdr.Off[ k ] = sizeof( BinHeader ) + k * lClmn;
+
+ oFile.write( reinterpret_cast< const char * >( &hdr ) , sizeof( BinHeader ) );
+
+ // write the n-vectors, a chunk at a time- - - - - - - - - - - - - - - - -
+
+ const int chnk = 8192;
+ double *buf = new double[ chnk ];
+
+ for( int k = 0 ; k < 4 ; k++ ) {
+  for( int strt = 0 ; strt < n ; strt += chnk ) {
+   const int stp = std::min( n , strt + chnk );
+   switch( k ) {
+    case( 0 ): KNPLCosts( buf , 0 , strt , stp ); break;
+    case( 1 ): KNPQCosts( buf , 0 , strt , stp ); break;
+    case( 2 ): KNPLBnds( buf , 0 , strt , stp ); break;
+    default:   KNPUBnds( buf , 0 , strt , stp );
+    }
+
+   oFile.write( reinterpret_cast< const char * >( buf ) ,
+		( stp - strt ) * sizeof( double ) );
+   }
+
+  std::memset( buf , 0 , 64 );  // pad up to the next multiple of 64
+  oFile.write( reinterpret_cast< const char * >( buf ) ,
+	       lClmn - n * sizeof( double ) );
+  }
+
+ delete[] buf;
+
+ }  // end( WriteInstanceBinary )
+
 /*--------------------------------------------------------------------------*/
 
  };  // end( namespace CQKnPClass_di_unipi_it )
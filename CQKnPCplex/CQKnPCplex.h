@@ -129,6 +129,8 @@ class CQKnPCplex : public CQKnPClass {
 
    const double *KNPGetX( void );
 
+   using CQKnPClass::KNPGetX;  // the components of the solution one by one
+
    double KNPGetPi( void );
 
    double KNPGetFO( void );
@@ -212,6 +214,9 @@ class CQKnPCplex : public CQKnPClass {
 /*--------------------------------------------------------------------------*/
 
    double *XSol;               ///< primal solution
+   int nMax;                   ///< size of XSol and of the scratch arrays
+   int *MInt;                  ///< scratch for LoadSet(): 3 * nMax ints
+   double *MDbl;               ///< scratch for LoadSet(): 4 * nMax doubles
 
    static CPXENVptr cplexEnv;  ///< Cplex environment (static)
    static int users;           ///< number of active instances
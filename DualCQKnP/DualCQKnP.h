@@ -54,12 +54,29 @@
 /**< If DualCQKnP_WHCH_QSORT == 0, the sort() function of the STL is used,
    otherwise a hand-made non-recursive quick-sort implementation is used.
 
-   \note Other than the performance impact, this choice has a consequence on
-         the thread-safety of the code. If DualCQKnP_WHCH_QSORT == 1, some
-	 temporary data structures are created that are shared among all
-	 "active" instances of DualCQKnP to save on space in the (frequent)
-	 case where many instances are simultaneously in memory. This is
-	 *not* thread-safe, while DualCQKnP_WHCH_QSORT == 0 is. */
+   \note If DualCQKnP_WHCH_QSORT == 1, each instance owns the stack used to
+         simulate the recursive calls (2 * n int), so that distinct instances
+	 can be used by distinct threads at the same time whatever the choice
+	 is. Of course, each single instance must still be used by one thread
+	 at a time. */
+
+#define DualCQKnP_PARALLEL 1
+
+/**< If DualCQKnP_PARALLEL == 1, the Radix Sort (see DualCQKnP::kRadixSort)
+   of large instances can be performed by multiple threads, see
+   SetThreads(). This requires C++11 std::thread, and the corresponding
+   linker flags (-pthread) are added by the makefile. If
+   DualCQKnP_PARALLEL == 0, the sort is always sequential. */
+
+#define DualCQKnP_SIMD 1
+
+/**< If DualCQKnP_SIMD == 1 and the code is compiled by g++ (or a compatible
+   compiler) for x86, the O( n ) loops that compute the breakpoints, check
+   feasibility and initialize the dual scan use AVX2 or AVX-512
+   instructions, chosen at run time according to what the CPU supports, see
+   SetSIMD(). Otherwise, only the portable implementation is compiled. All
+   of them accumulate the sums in the same order, hence the results are
+   exactly the same (bit by bit) whatever instructions are used. */
 
 #define DualCQKnP_SANITY_CHECKS 0
 
@@ -84,6 +101,131 @@ namespace CQKnPClass_di_unipi_it
 /*--------------------------------------------------------------------------*/
 /*---------------------------- CLASSES -------------------------------------*/
 /*--------------------------------------------------------------------------*/
+
+template< class DT , class ST > class DualCQKnPT;
+
+class ThrdPool;  // the threads started by DualCQKnPT::SetThreads()
+
+/*--------------------------------------------------------------------------*/
+/** Class describing the whole "solution path" of an instance, i.e., the
+    optimal multiplier mu( V ), the optimal value v( V ) and the optimal
+    solution x( V ) as functions of the volume V; it is constructed by
+    DualCQKnPT::SolvePath(), and it does not depend on the solver
+    afterwards. It is the same class whatever the template parameters of
+    the solver, which is known to its users as DualCQKnP::SolPath.
+
+    The total volume S( mu ) of the solution x( mu ) minimizing the
+    Lagrangian is a nondecreasing piecewise-linear function of mu. It is
+    described by the nb = NrPoints() points Mu()[ 0 ] < ... < Mu()[ nb - 1 ]:
+    in the j-th one S( mu ) jumps from Vl()[ j ] to Vr()[ j ] (these are
+    equal unless items with zero quadratic cost have their breakpoint
+    there), and between Mu()[ j ] and Mu()[ j + 1 ] it grows at rate
+    Gm()[ j ]. Hence, v( V ) is linear in each [ Vl()[ j ] , Vr()[ j ] ],
+    where mu( V ) = Mu()[ j ] and
+
+      v( V ) = Fr()[ j ] + Mu()[ j ] * ( V - Vr()[ j ] ) ,
+
+    and it is quadratic in each [ Vr()[ j ] , Vl()[ j + 1 ] ], where
+
+      mu( V ) = Mu()[ j ] + d  with  d = ( V - Vr()[ j ] ) / Gm()[ j ]
+
+      v( V ) = Fr()[ j ] + Gm()[ j ] * d * ( Mu()[ j ] + d / 2 ) .
+
+    The piece on the right of Mu()[ nb - 1 ] is of the second type if the
+    optimal multiplier can be arbitrarily large, and of the first type
+    (with Vr()[ nb - 1 ] replaced by + INF) otherwise; symmetrically, the
+    piece on the left of Mu()[ 0 ] is of the first type (with Vl()[ 0 ]
+    replaced by - INF) if the multiplier is bounded below, and of the
+    second type with rate GmL() otherwise. All these are obtained by a
+    single scan of the sorted breakpoints, and each call to Eval() and
+    GetX() costs O( lg nb ). */
+
+class DualCQKnPSolPath {
+
+ public:
+
+   DualCQKnPSolPath( void );
+
+   ~DualCQKnPSolPath();
+
+   CQKnPClass::CQKStatus Eval( const double V , double *mu = 0 ,
+			       double *fo = 0 );
+
+/**< Computes the optimal multiplier and the optimal value for the volume V
+   (any of mu and fo can be 0), returning the status that SolveKNP() would
+   return; *mu and *fo are set as in CQKnPClass::SolveVlms(). */
+
+   double GetX( const int i , const double V );
+
+/**< Returns the optimal value of the i-th variable for the volume V, which
+   must be feasible (Eval( V ) == kOK). The items with zero quadratic cost
+   and the breakpoint in mu( V ) share the volume proportionally to the
+   size of their interval. */
+
+   void GetX( const double V , double *x );
+
+/**< Writes in x[ i ] what GetX( i , V ) would return, for all the items. */
+
+   void Write( std::ostream &os );
+
+   void Read( std::istream &is );
+
+/**< Write() writes the path to os in a binary format, which Read() reads
+   back replacing the current content of the object; os and is should be
+   opened in binary mode. Read() throws CQKException if the header is not
+   that of a path written by Write(), which is checked before the object
+   is changed, or if the stream ends too early. */
+
+   int NrPoints( void ) { return( nb ); }
+
+   const double *Mu( void ) { return( PMu ); }
+
+   const double *Vl( void ) { return( PVl ); }
+
+   const double *Vr( void ) { return( PVr ); }
+
+   const double *Fr( void ) { return( PFr ); }
+
+   const double *Gm( void ) { return( PGm ); }
+
+   double GmL( void ) { return( PGmL ); }
+
+ private:
+
+   template< class DT , class ST > friend class DualCQKnPT;
+
+   void Alloc( const int pn , const int pnb );
+
+   void DeAlloc( void );
+
+   int Locate( const double V , double &mu , double &fo );
+
+   double ItemX( const int i , const int j , const double V ,
+		 const double mu );
+
+  int n;          ///< number of items
+  int nb;         ///< number of points
+  int St;         ///< kOK, or kUnbounded if the dual is empty
+  double VMin;    ///< the smallest feasible volume
+  double VMax;    ///< the largest feasible volume
+  double PGmL;    ///< the rate on the left of Mu()[ 0 ], if unbounded
+  bool PinL;      ///< true if mu >= Mu()[ 0 ] always
+  bool PinR;      ///< true if mu <= Mu()[ nb - 1 ] always
+  int LBItm;      ///< item taking the volume below Vl()[ 0 ], if PinL
+  int UBItm;      ///< item taking the volume above Vr()[ nb - 1 ], if PinR
+  double *PMu;    ///< the points
+  double *PVl;    ///< S( mu ) on the left of the points
+  double *PVr;    ///< S( mu ) on the right of the points
+  double *PFr;    ///< the objective value on the right of the points
+  double *PGm;    ///< the rate of S( mu ) on the right of the points
+  double *PA;     ///< the lower bounds
+  double *PB;     ///< the upper bounds
+  double *PC;     ///< the linear costs
+  double *PD;     ///< the quadratic costs
+
+ };  // end( class DualCQKnPSolPath )
+
+/*--------------------------------------------------------------------------*/
 /** Solver of Continuous Quadratic Knapsack Problems (CQKnP) based on the
     standard formulation of the dual problem as a piecewise-convex problem
     in the unique multiplier of the knapsack constraint and the corresponding
@@ -93,9 +235,33 @@ namespace CQKnPClass_di_unipi_it
  
     Derives from CQKnpClass and therefore it \e mostly conforms to its
     interface, except for refusing to solve instances without the required
-    characteristics. */
-
-class DualCQKnP : public CQKnPClass {
+    characteristics.
+
+    The class is a template over the type DT in which the costs and the
+    bounds of the items (C, D, A and B) are stored and the type ST in which
+    phi'( mu ), its rate and the other sums over all the items (such as
+    the sums of the bounds and the optimal value) are accumulated, which
+    are available as DType and SType. DualCQKnP is the usual
+    DualCQKnPT< double , double >. DualCQKnP.C explicitly instantiates DT
+    among float, double and long double and ST among double and long
+    double, with ST never less precise than DT, and solvers with different
+    types can be used in the same program.
+
+    Storing the data as float halves the memory traffic of the O( n ) loops
+    (PreSort(), KNPGetX(), ...) on very large instances, at the cost of
+    rounding the data to 7 digits when they are loaded; infinite bounds are
+    then stored as the IEEE infinities, and the methods reading the data
+    turn them back into +/- Inf<double>(). Storing them, and accumulating
+    the sums, as long double helps with ill-conditioned data. The
+    interface of the class always uses double, and the breakpoints, the
+    primal solution and the multiplier are always double. If DT is not
+    double, LoadView() cannot borrow the caller's arrays: it copies them as
+    LoadSet() does, and ChgView() copies them again, so that the semantic
+    is the same. The vector instructions (see DualCQKnP_SIMD) are only used
+    if both DT and ST are double. */
+
+template< class DT , class ST >
+class DualCQKnPT : public CQKnPClass {
 
 /*--------------------------------------------------------------------------*/
 /*----------------------- PUBLIC PART OF THE CLASS -------------------------*/
@@ -103,13 +269,37 @@ class DualCQKnP : public CQKnPClass {
 
  public:
 
+/*--------------------------------------------------------------------------*/
+/*---------------------------- PUBLIC TYPES --------------------------------*/
+/*--------------------------------------------------------------------------*/
+
+/** Public enum describing the possible algorithms, see the constructor. */
+
+  enum DualAlgo { kBubbleSort = 0 ,  ///< dual ascent with Bubble Sort
+		  kQuickSort  = 1 ,  ///< dual ascent with Quick Sort
+		  kNewton     = 2 ,  ///< safeguarded Newton, no sorting
+		  kRadixSort  = 3 ,  ///< dual ascent with Radix Sort
+		  kLazyHeap   = 4 ,  ///< dual ascent with a heap, see below
+		  kAutoSort   = 5    ///< dual ascent with an adaptive sort
+                  };
+
+/** Public types of the stored data and of the sums, see above. */
+
+  typedef DT DType;  ///< type of C, D, A and B
+  typedef ST SType;  ///< type of the sums over the items
+
+/** The class describing the solution path, see DualCQKnPSolPath. */
+
+  typedef DualCQKnPSolPath SolPath;
+
+
 /*--------------------------------------------------------------------------*/
 /*--------------------------- PUBLIC METHODS -------------------------------*/
 /*--------------------------------------------------------------------------*/
 /*---------------------------- CONSTRUCTOR ---------------------------------*/
 /*--------------------------------------------------------------------------*/
 
-   DualCQKnP( const bool sort = true , const double eps = 1e-6 );
+   DualCQKnPT( const int sort = kAutoSort , const double eps = 1e-6 );
 
 /**< The most important operation for solving the CQKnP with a dual method is
    the sorting of the items for nondecreasing elements
@@ -119,16 +309,55 @@ class DualCQKnP : public CQKnPClass {
    If the knapsack is a large one, this can be (relatively) time-consuming.
    Different sort procedures can be better in different situations, and the
    parameter 'sort' allows to decide which among the available sorting
-   procedures has to be used. Possible values of this parameter are:
-
-   false  Bubble Sort: this is O( n^2 ) on average, but it can be very fast -
-          O( n ) - if reoptimizing from a previous problem where the order
-	  was not very different (e.g., only few costs have changed).
-
-   true   [default] Quick Sort: this is O( n lg n ) on average and pretty
-          efficient in practice, but can be very slow - O( n^2 ) - if the
-          vector is already (almost) ordered, e.g. when reoptimizing from a
-          previous problem where only few costs have changed.
+   procedures has to be used, or if sorting has to be avoided altogether.
+   Possible values of this parameter are (for backward compatibility, false
+   and true can still be used for the first two):
+
+   kBubbleSort  Bubble Sort: this is O( n^2 ) on average, but it can be very
+                fast - O( n ) - if reoptimizing from a previous problem
+		where the order was not very different (e.g., only few costs
+		have changed).
+
+   kQuickSort   Quick Sort: this is O( n lg n ) on average and
+                pretty efficient in practice, but can be very slow - O( n^2 )
+		- if the vector is already (almost) ordered, e.g. when
+		reoptimizing from a previous problem where only few costs
+		have changed.
+
+   kNewton      no sorting at all: the root of the (monotone and piecewise
+                linear) derivative phi'( mu ) of the dual function is found
+		by a Newton method safeguarded by secant and bisection steps.
+		Each iteration costs O( n ) and usually only a handful of
+		them are needed, which is typically the best choice for large
+		instances that are seldom reoptimized; the number of
+		iterations of the last call to SolveKNP() is returned by
+		KNPGetIter().
+
+   kRadixSort   Radix Sort: an LSD radix sort over the bit representation
+                of the values. This is O( n ) but with a large constant and
+		O( n ) extra memory, hence it is mostly useful for very large
+		instances solved from scratch.
+
+   kLazyHeap    no sorting: the breakpoints are put in a binary heap in
+                O( n ), and the dual ascent extracts them in order only as
+		it needs them, in O( lg n ) each. This is O( n + k lg n ),
+		with k the number of breakpoints smaller than the optimal
+		multiplier, hence it is best when the optimal multiplier is
+		among the smallest breakpoints. It is never warm-started
+		(see KNPGetIter()).
+
+   kAutoSort    [default] the sort adapts to how much the vector is
+                already ordered, which is the case when reoptimizing after
+		many items have changed (when only a few have, their
+		breakpoints are just moved in the sorted vector, whatever
+		the sort). The elements out of order are dropped from the
+		vector as it is scanned, then they are sorted apart and
+		merged back, which is O( n + m lg m ) with m the dropped
+		ones; if these are too many, an introsort is used, which is
+		O( n lg n ) in the worst case. So, no vector is ever sorted
+		in O( n^2 ), and neither Bubble Sort nor Quick Sort have to
+		be chosen depending on the changes (SetSort() can still be
+		used to force one of them).
 
    The parameter Eps defines the precision required to construct the
    solution [default value is 1e-6].
@@ -145,6 +374,64 @@ class DualCQKnP : public CQKnPClass {
 		 const double *pA = 0 , const double *pB = 0 ,
 		 const double pV = 0 , const bool sns = true );
 
+/*--------------------------------------------------------------------------*/
+
+   void LoadView( const int pn ,
+		  const double *pC , const double *pD ,
+		  const double *pA , const double *pB ,
+		  const double pV = 0 , const bool sns = true );
+
+   void ChgView( void );
+
+/**< LoadView() is the same as LoadSet(), except that the non-0 arrays
+   among pC, pD, pA and pB are not copied: the object "borrows" them, and
+   reads the data directly from the caller's memory. Hence, these arrays
+   must remain valid until the object is destroyed or a new instance is
+   loaded (with LoadSet() or LoadView()).
+
+   The object never writes in a borrowed array: the first time one of the
+   Chg*() methods (say, ChgLCost()) changes a borrowed array, the object
+   makes its own copy of that array (and of that one only), changes it and
+   uses it from then on, so that later changes of the caller's array are no
+   longer seen. Alternatively, the caller can change its arrays directly,
+   but then it must call ChgView() before the next call to SolveKNP() (or
+   to any method that reads the data); ChgView() only records that all the
+   data may have changed, which means that the next SolveKNP() cannot use
+   the previous solution and has to sort all the breakpoints again. */
+
+/*--------------------------------------------------------------------------*/
+
+   void ReadInstanceBinary( const char *fName );
+
+/**< Same as CQKnPClass::ReadInstanceBinary(), except that the data is
+   loaded with LoadView() [see above] straight from the file mapped in
+   memory, so that nothing is parsed nor copied (unless DType is not
+   double). The file is released only when a new instance is loaded or the
+   object is destroyed. The mapping is read-only, which is not a problem
+   since the object never writes in a borrowed array. */
+
+/*--------------------------------------------------------------------------*/
+
+   void Reserve( const int nmax );
+
+   void ShrinkToFit( void );
+
+/**< The memory of the object is sized for a number of items (its capacity)
+   which can be larger than the current one. LoadSet() only allocates
+   memory if the new instance does not fit, and then it increases the
+   capacity by at least one half, so that a sequence of instances of
+   varying size stops allocating memory once the largest one has been
+   loaded. Reserve() makes the capacity at least nmax, and ShrinkToFit()
+   makes it exactly the current number of items (releasing all the memory
+   if there are none); both keep the current instance and its solution.
+   All the arrays whose size depends on the number of items are allocated
+   as a single block, each one starting at the beginning of a cache line.
+
+   Once the capacity is large enough, reoptimizing (the Chg*() methods,
+   SolveKNP(), KNPGetX() and KNPGetFO()) allocates no memory, even if more
+   than one thread is used: the Radix Sort, SolveBatch() and ParDualCQKnP
+   run on the threads started once and for all by SetThreads(). */
+
 /*--------------------------------------------------------------------------*/
 
 #if CQKnPClass_LOG
@@ -166,7 +453,7 @@ class DualCQKnP : public CQKnPClass {
 
 /*--------------------------------------------------------------------------*/
 
-   inline void SetSort( const bool WhchSrt = false );
+   void SetSort( const int WhchSrt = kBubbleSort );
 
 /**< Allows to change the sorting procedures to be used in the next calls to
    SolveKNP(); see the comments to the constructor for details. */
@@ -175,22 +462,127 @@ class DualCQKnP : public CQKnPClass {
 
    inline void SetEps(const double Eps = 1e-6 );
 
+/*--------------------------------------------------------------------------*/
+
+   void SetThreads( const int NThr = 1 );
+
+/**< Sets the maximum number of threads that can be used by the Radix Sort
+   (see kRadixSort) and by SolveBatch(); this only has an effect if
+   DualCQKnP_PARALLEL == 1. Small instances are always sorted by one
+   thread, since each thread must have at least a few tens of thousands of
+   items to sort. The result is exactly the same (bit by bit) as that of
+   the sequential Radix Sort, whatever the number of threads.
+
+   The NThr - 1 threads besides the calling one are started here, and they
+   sleep until some work is given to them; they are stopped only when
+   SetThreads() changes their number or the object is destroyed. So, the
+   cost (and the memory allocation) of starting them is paid once, rather
+   than at each call to SolveKNP() or SolveBatch(). */
+
+/*--------------------------------------------------------------------------*/
+
+   void SetSIMD( const int Lvl = 2 );
+
+/**< Sets the most advanced vector instructions that can be used: 0 means the
+   portable implementation, 1 means up to AVX2 and 2 [default] up to
+   AVX-512. The instructions actually used are also limited by the CPU, and
+   they are always the portable ones if DualCQKnP_SIMD == 0. */
+
 /*--------------------------------------------------------------------------*/
 /*---------------------- METHODS FOR SOLVING THE PROBLEM -------------------*/
 /*--------------------------------------------------------------------------*/
 
    CQKnPClass::CQKStatus SolveKNP( void );
 
+/*--------------------------------------------------------------------------*/
+
+   void SolveVlms( const int m , const double *Vlms ,
+		   double *Pi = 0 , double *FO = 0 , CQKStatus *Stt = 0 );
+
+/**< Solves the instance for all the m volumes in Vlms[], see
+   CQKnPClass::SolveVlms(), without changing the current volume and the
+   current solution. The breakpoints are sorted once (if they are not
+   already, whatever the choice in SetSort()), a single scan of them
+   constructs the solution path (see SolvePath()), and then each volume is
+   found in it by binary search, which costs O( n lg n + m lg n ). The
+   optimal values are updated along the scan rather than computed from the
+   primal solutions, which are never constructed; hence they may slightly
+   differ from what KNPGetFO() would return. */
+
+/*--------------------------------------------------------------------------*/
+
+   void SolvePath( SolPath &Pth );
+
+/**< Constructs in Pth the whole solution path of the instance, see SolPath,
+   without changing the current volume and the current solution. Like
+   SolveVlms(), this costs one sort of the breakpoints (if they are not
+   already sorted) and one scan of them, plus O( n ) memory in Pth. */
+
+/*--------------------------------------------------------------------------*/
+
+   void SolveBatch( const int nb , const int *Bgn ,
+		    const double *pC , const double *pD ,
+		    const double *pA , const double *pB ,
+		    const double *pV , const bool *sns ,
+		    double *X , double *Pi = 0 , double *FO = 0 ,
+		    CQKStatus *Stt = 0 );
+
+/**< Solves nb independent instances ("blocks"), which have nothing to do
+   with the current one (that is not changed). The data of all the blocks
+   are packed: the items of the h-th block are Bgn[ h ] , ... ,
+   Bgn[ h + 1 ] - 1 (Bgn[] has nb + 1 elements, with Bgn[ 0 ] == 0), and
+   their costs and bounds are the corresponding elements of pC[], pD[],
+   pA[] and pB[], with the same meaning (and defaults if 0) as in
+   LoadSet(); the volume and the sense of the h-th block are pV[ h ] and
+   sns[ h ] (0 means 0 and true, respectively).
+
+   The optimal solution of the h-th block is written in X[ Bgn[ h ] ] ,
+   ... , X[ Bgn[ h + 1 ] - 1 ] if it is solved to optimality, while
+   Pi[ h ], FO[ h ] and Stt[ h ] are set as in SolveVlms(); any of X, Pi,
+   FO and Stt can be 0 if that information is not needed.
+
+   The blocks are solved by up to as many threads as set by SetThreads(),
+   each one taking the next unsolved block when it is done with the
+   previous one. Each thread uses a "worker" solver of the same class as
+   this object (see NewWrkr()), which reads the data of the blocks directly
+   from the packed arrays (see LoadView()). The workers have the same
+   parameters as this object, except that kRadixSort is replaced by
+   kQuickSort since the blocks are supposed to be small; so, the result
+   does not depend on the number of threads unless the solution of a block
+   depends on the previous ones solved by the same object (as in
+   SelDualCQKnP, whose pivots are random). The workers are
+   kept until this object is destroyed, and their memory only grows up to
+   the size of the largest block: hence, in a sequence of calls with blocks
+   of similar size the workers allocate no memory after the first one. */
+
 /*--------------------------------------------------------------------------*/
 /*---------------------- METHODS FOR READING RESULTS -----------------------*/
 /*--------------------------------------------------------------------------*/
 
    const double *KNPGetX( void );
 
+   void KNPGetX( double *x , const int *nms = 0 ,
+		 int strt = 0 , int stp = Inf<int>() );
+
+/**< Unless the whole solution has already been computed by KNPGetX( void )
+   (or KNPGetFO()), the required components are computed from the optimal
+   multiplier, in O( 1 ) each; so, the O( n ) pass of KNPGetX( void ) is
+   avoided if only a few of them are needed. */
+
    double KNPGetPi( void );
 
    double KNPGetFO( void );
 
+   inline int KNPGetIter( void );
+
+/**< Returns the number of iterations performed by the last call to
+   SolveKNP(). For the algorithms not based on sorting (e.g., kNewton) these
+   are the iterations of the method, each costing O( n ). For the ones based
+   on sorting this is the number of breakpoints crossed when the scan could
+   be warm-started from the previous optimal solution (see WarmDualSol()),
+   and 0 otherwise. For kLazyHeap, this is the number of breakpoints
+   extracted from the heap. */
+
 /*--------------------------------------------------------------------------*/
 /*-------------- METHODS FOR READING THE DATA OF THE PROBLEM ---------------*/
 /*--------------------------------------------------------------------------*/
@@ -249,7 +641,7 @@ class DualCQKnP : public CQKnPClass {
 /*------------------------------ DESTRUCTOR --------------------------------*/
 /*--------------------------------------------------------------------------*/
 
-   ~DualCQKnP();
+   ~DualCQKnPT();
 
 /*--------------------------------------------------------------------------*/
 /*--------------------- PROTECTED PART OF THE CLASS ------------------------*/
@@ -284,20 +676,160 @@ class DualCQKnP : public CQKnPClass {
 
    virtual void PreSort( void );
 
+   virtual void Sort( void );
+
    virtual void FindDualSol ( void );
 
+   virtual void NewtonDualSol( void );
+
 /* These methods are virtual to allow derived classes to extend the base one
    to handling of more "complicated" instances, such as with zero quadratic
-   costs and/or infinite bounds. */
+   costs and/or infinite bounds. Sort() orders I[] for nondecreasing values
+   of OV[] prior to calling FindDualSol(), and can be redefined by derived
+   classes whose FindDualSol() does not need I[] to be fully sorted.
+   NewtonDualSol() is called in place of Sort() + FindDualSol() when
+   WSort == kNewton, and only needs OV[] to be computed by PreSort(). */
+
+   virtual bool WarmDualSol( void );
+
+   virtual void SaveDualSol( void );
+
+/**< WarmDualSol() is called in place of FindDualSol() if a previous optimal
+   solution is known: it restarts the scan of the sorted breakpoints from
+   the previous optimal mu, costing O( breakpoints crossed ), and returns
+   false if it cannot. Then FindDualSol() is called, and SaveDualSol()
+   keeps phi'() and its rate in the last point reached by the scan, which
+   the Chg*() methods update in O( 1 ) per item; they are computed from
+   scratch again once they have been updated n times, so that the
+   rounding errors do not pile up. Derived classes whose FindDualSol()
+   does not sort I[] must redefine them to return false and to do
+   nothing. */
+
+   inline void WrmPnt( const double mu , const SType beta ,
+		       const SType gamma , const int k );
+
+/**< Called by FindDualSol() when it stops, to record the last point mu of
+   its scan, where phi'( mu + ) is beta and its rate is gamma once the
+   breakpoints I[ 0 .. k ) have been passed; SaveDualSol() passes those in
+   I[ k .. ) which are equal to mu. This costs nothing, while computing
+   phi'() in the optimal mu would cost O( n ) to the calls to SolveKNP()
+   which are never followed by a reoptimization. */
+
+   virtual int ItemBrk( const int k , int *nm );
+
+/**< Writes in nm[] the names (as in I[]) of the breakpoints of the k-th
+   item, computes their values in OV[] and returns how many they are (at
+   most 2). It is used to move the breakpoints of each changed item to
+   their new position in the sorted I[], in O( lg n ) plus the distance
+   moved, for at most n / 64 + 16 items between two calls to SolveKNP()
+   and a total distance of at most 2 * nSort; beyond that, I[] is sorted
+   again. */
+
+   virtual double ItemSol( const int k );
+
+/**< Returns the k-th component of the solution computed from muStar, which
+   is what KNPGetX( void ) would write in XSol[ k ]; it is only called by
+   KNPGetX( x , nms , strt , stp ) when status == kOK and XSol[] has not
+   been computed yet. */
+
+   inline int Brk( const int k );
+
+/**< Returns I[ k ], the k-th breakpoint in nondecreasing order. With
+   kLazyHeap they are extracted from a heap as Brk() asks for them, so
+   FindDualSol() must read any new position of I[] through Brk(), in
+   increasing order of k. */
+
+   static inline void ChkBrkPnt( const double v , const double mu ,
+				 const double muLo , const double muHi ,
+				 int &cL , int &cR , double &bL , double &bR );
+
+/**< Counts the breakpoint v in cL if it is in ( muLo , mu ) and in cR if it
+   is in ( mu , muHi ), and updates the largest breakpoint bL < mu and the
+   smallest bR > mu; the Newton methods use it to know when the interval
+   of uncertainty has few enough breakpoints to be scanned. */
+
+   static inline int ItemShp( const DType a , const DType b ,
+			      const DType d );
+
+/**< Returns the Shp* bits (see Shape) that hold for the item with bounds a
+   and b and quadratic cost d. */
+
+   void ZeroDBnds( double &lb , double &ub );
+
+   void InitDer( SType &beta , SType &gamma );
+
+   bool SumBnds( SType &sumA , SType &sumB );
+
+   void ZeroDBndsP( const int p , const int np );
+
+   void SumBndsP( const int p , const int np );
+
+   void PreSortP( const int p , const int np );
+
+/**< ZeroDBnds() decreases ub to the smallest C[ k ] among the items with
+   D[ k ] == 0 and B[ k ] == INF, and increases lb to the largest C[ k ]
+   among those with D[ k ] == 0 and A[ k ] == - INF. InitDer() adds to beta
+   and gamma the contributions to phi'( mu ) and to its rate of all the
+   items for mu smaller than all the breakpoints. SumBnds() computes the
+   sums of all the lower and upper bounds, and returns false if
+   A[ k ] > B[ k ] for some k. Like PreSort(), which computes both the
+   breakpoints of all the items in OV[] (C[ k ] if D[ k ] == 0), they use
+   vector instructions and only recompute the blocks marked in Drt[]. As
+   the data may be float (see DType), infinite bounds are recognised by
+   A[ k ] <= - INF and B[ k ] >= INF. ZeroDBndsP(), SumBndsP() and
+   PreSortP() only do the recomputation, for the blocks in the p-th of np
+   equal parts of them: parts with different p can be done in parallel,
+   and once all of them are done, ZeroDBnds() and SumBnds() only add up
+   the results of the blocks, in the same order, and PreSort() does
+   nothing. */
+
+   virtual DualCQKnPT *NewWrkr( void );
+
+/**< Returns a new object of the same class as this one, used by
+   SolveBatch() to solve the blocks; the parameters are set by the caller.
+   Derived classes that can be used there must redefine it. */
+
+   void ThrdRun( const int nT , void ( *f )( const int , void * ) ,
+		 void *arg );
+
+/**< Runs f( t , arg ) for t = 0 , ... , nT - 1 and returns when all of
+   them are done: t == 0 in the calling thread, the others in the threads
+   started by SetThreads() (in turn, if nT is larger than their number).
+   If there are none, all of them are run by the calling thread. */
 
 /*--------------------------------------------------------------------------*/
 /*----------------------- PROTECTED DATA STRUCTURES  -----------------------*/
 /*--------------------------------------------------------------------------*/
 
-  double *A;         ///< vector of lower bounds
-  double *B;         ///< vector of upper bounds
-  double *C;         ///< vector of linear costs
-  double *D;         ///< vector of quadratic costs
+  DType *A;          ///< vector of lower bounds
+  DType *B;          ///< vector of upper bounds
+  DType *C;          ///< vector of linear costs
+  DType *D;          ///< vector of quadratic costs
+  DType *OA;         ///< the solver's own memory for A[]
+  DType *OB;         ///< the solver's own memory for B[]
+  DType *OC;         ///< the solver's own memory for C[]
+  DType *OD;         ///< the solver's own memory for D[]
+  int Brrwd;         ///< which ones of A, B, C and D are borrowed
+  const double *VwA; ///< the array given to LoadView() for A[], if not kept
+  const double *VwB; ///< the array given to LoadView() for B[], if not kept
+  const double *VwC; ///< the array given to LoadView() for C[], if not kept
+  const double *VwD; ///< the array given to LoadView() for D[], if not kept
+  const BinHeader *BinMap; ///< the file mapped by ReadInstanceBinary()
+  size_t BinLen;     ///< the length of BinMap
+  int Shape;         ///< which properties hold for all the items
+
+/**< Shape is made of the Shp* bits below. LoadSet(), LoadView() and
+   ChgView() compute it with one scan, then the Chg*() methods only reset
+   the bits violated by the changed items. ZeroDBnds() does nothing if
+   ShpCnvx is set and InitDer() if ShpZLB is; derived classes choose with
+   it, once per call, the version of their O( n ) loops (see ExDualCQKnP).
+   */
+
+  static const int ShpCnvx = 1;  ///< D[ k ] > 0 for all k
+  static const int ShpFnt  = 2;  ///< all the bounds are finite
+  static const int ShpZLB  = 4;  ///< A[ k ] == 0 for all k
+  static const int ShpAll  = 7;  ///< all of them
+
   double  McB;       ///< volume value
   bool sense;        ///< sense of knapsack constraint
 
@@ -312,16 +844,48 @@ class DualCQKnP : public CQKnPClass {
   double *XSol;      ///< primal solution
   double muStar;     ///< optimal dual solution
 
-  bool WSort;        ///< which sorting procedure is used
+  int WSort;         ///< which sorting procedure (DualAlgo) is used
+  int NrIter;        ///< iterations of the last call to SolveKNP()
   double OptVal;     ///< The Optimal Value
 
   double DefEps;   ///< precision required to construct the solution
 
-  #if DualCQKnP_WHCH_QSORT
-   static int *QSStck;   ///< the stack to simulate recursive calls in QS
-   static int InstCntr;  ///< number of active instances
+  int NThrds;      ///< max number of threads for sorting
+  int SIMDLv;      ///< vector instructions used: 0 none, 1 AVX2, 2 AVX-512
+
+  bool WrmSt;      ///< true if the warm start information is valid
+  int WKInd;       ///< how many items of I[] are <= WMu, < 0 if unknown
+  double WMu;      ///< the last point of the previous scan
+  SType WBeta;     ///< phi'( WMu ) (the right derivative)
+  SType WGamma;    ///< - phi''( WMu ) (the right derivative)
+  int WNrUpd;      ///< updates of WBeta and WGamma since they were computed
+
+  bool SrtdI;      ///< true if I[] is sorted
+  int *ChgI;       ///< the items changed since I[] was last sorted
+  int *ChgN;       ///< the names of their breakpoints when I[] was sorted
+  bool *ChgMrk;    ///< ChgMrk[ k ] == true if k is in ChgI[]
+  int nChg;        ///< how many items are in ChgI[]
+  int ChgMax;      ///< max number of items in ChgI[]
+
+  char *Drt;       ///< what is to be computed again in each block of items
+  SType *BlkS;     ///< the sums of A[] and B[] in each block
+  double *BlkZ;    ///< lb and ub of ZeroDBnds() in each block
+
+/**< The items are split in blocks of a few hundred ones, and the Chg*()
+   methods mark in Drt[] the blocks of the changed items: PreSort(),
+   SumBnds() and ZeroDBnds() only recompute the marked blocks, and the
+   results of the last two are kept per block in BlkS[] and BlkZ[]. So, a
+   call to SolveKNP() after a change of a few items costs O( n ) only in
+   the dual ascent proper. */
+
+  int nAlc;        ///< number of items for which memory is allocated
+  char *MemBlk;    ///< the memory of all the arrays
+  DualCQKnPT **Wrkr;  ///< the workers of SolveBatch()
+  int NWrkr;       ///< how many they are
+  ThrdPool *Pool;  ///< the threads started by SetThreads(), 0 if none
 
-   static int maxvl;     ///< max value of items
+  #if DualCQKnP_WHCH_QSORT
+   int *QSStck;     ///< the stack to simulate recursive calls in QS
   #endif
 
 /*--------------------------------------------------------------------------*/
@@ -331,18 +895,87 @@ class DualCQKnP : public CQKnPClass {
  private:
 
 /*--------------------------------------------------------------------------*/
-/*-------------------------- PRIVATE METHODS -----------------------------*/
+/*-------------------------- PRIVATE TYPES -------------------------------*/
 /*--------------------------------------------------------------------------*/
 
-  void qsort( void );  // the Quick Sort
+  struct BrkRec {  ///< a breakpoint during the sort
+   double v;       ///< its value, i.e., OV[ nm % ( 2 * n ) ]
+   int nm;         ///< its name in I[]
+   };
 
-  void bsort( void );  // the Bubble Sort
+/* Except for the Radix Sort, which reads each value only once anyway,
+   Sort() copies the breakpoints in an array of BrkRec, sorts it and writes
+   the names back in I[]. So the comparisons and the swaps of the sorting
+   algorithms access the values sequentially, and they never compute the
+   position in OV[] of a name. */
 
 /*--------------------------------------------------------------------------*/
+/*------------------------ PRIVATE DATA STRUCTURES -------------------------*/
+/*--------------------------------------------------------------------------*/
+
+  char *SrtM;      ///< the scratch memory of Sort() and rsort()
+  size_t SrtMSz;   ///< its size
+
+  BrkRec *Heap;    ///< the heap of the Lazy Heap (in SrtM)
+  int nHeap;       ///< how many breakpoints are still in the heap
+  int nSrtd;       ///< I[ 0 .. nSrtd ) are known, Inf<int>() if all
+
+/*--------------------------------------------------------------------------*/
+/*-------------------------- PRIVATE METHODS -----------------------------*/
+/*--------------------------------------------------------------------------*/
+
+  void qsort( BrkRec *R );  // the Quick Sort
+
+  void bsort( BrkRec *R );  // the Bubble Sort
+
+  void rsort( void );       // the Radix Sort
+
+  void dmsort( BrkRec *R , BrkRec *T );  // the Drop-Merge Sort
+
+  void hbuild( BrkRec *R , const int m );  // the heap of the Lazy Heap
+
+  inline void hsift( int h , const BrkRec r );  // move r down from h
+
+  void hpop( const int k );  // extract from the heap up to I[ k ]
+
+  void hdone( void );        // put back in I[] what is left in the heap
+
+  inline void WrmUpd( const int k , const bool add );
+
+  void WrmPass( void );  // pass the breakpoints of I[ WKInd .. ) <= WMu
+
+  void WrmSync( void );  // compute WBeta and WGamma from scratch
+
+  inline void MrkChg( const int k , const int flg );
+
+  inline void MrkDrt( const int k , const int flg );
+
+  void InsSort( void );  // re-insert the changed items in I[]
+
+  void DropChg( int c );  // forget the changed items, sort I[] again
+
+  void LoadData( const int pn ,
+		 const double *pC , const double *pD ,
+		 const double *pA , const double *pB ,
+		 const double pV , const bool sns , const bool view );
+
+  inline void CopyArr( const int brw );  // copy-on-write of a borrowed array
+
+  void SetShape( void );  // compute Shape by scanning all the items
+
+  static inline double Bnd( const DType b );  // b as a double, INF included
+
+  char *SrtMem( const size_t sz );  // scratch memory for sorting
+
+  void UpdI( void );     // update the names in I[]
 
-  inline void MemAlloc( void );
+  void SortI( void );    // compute the breakpoints and sort them if needed
 
-  inline void MemDeAlloc( void );
+  void MkPath( SolPath &Pth , const bool itms );  // itms: copy the items
+
+/*--------------------------------------------------------------------------*/
+
+  void MemRsz( const int cap , const bool keep );  // keep: copy the data
 
 /*--------------------------------------------------------------------------*/
 
@@ -356,59 +989,149 @@ class DualCQKnP : public CQKnPClass {
   void Log4( void );
  #endif
 
- };  // end( class DualCQKnP )
+ };  // end( class DualCQKnPT )
+
+/*--------------------------------------------------------------------------*/
+/** The solver with the data stored and the sums accumulated in double. */
+
+typedef DualCQKnPT< double , double > DualCQKnP;
 
 /*--------------------------------------------------------------------------*/
 /*------------------- inline methods implementation ------------------------*/
 /*--------------------------------------------------------------------------*/
 
-inline void DualCQKnP::SetSort( const bool WhchSrt )
-{
- WSort = WhchSrt;
+template< class DT , class ST >
+inline void DualCQKnPT< DT , ST >::SetEps( const double eps ) {
+
+ DefEps = eps ;
  }
 
 /*--------------------------------------------------------------------------*/
 
-inline void DualCQKnP::SetEps( const double eps ) {
-
- DefEps = eps ;
+template< class DT , class ST >
+inline int DualCQKnPT< DT , ST >::KNPGetIter( void )
+{
+ return( NrIter );
  }
 
 /*--------------------------------------------------------------------------*/
 
-inline double DualCQKnP::KNPLCost( const int i )
+template< class DT , class ST >
+inline double DualCQKnPT< DT , ST >::KNPLCost( const int i )
 {
  return( C[ i ] );
  }
 
 /*--------------------------------------------------------------------------*/
 
-inline double DualCQKnP::KNPQCost( const int i )
+template< class DT , class ST >
+inline double DualCQKnPT< DT , ST >::KNPQCost( const int i )
 {
  return( D[ i ] );
  }
 
 /*--------------------------------------------------------------------------*/
 
-inline double DualCQKnP::KNPLBnd( const int i )
+template< class DT , class ST >
+inline double DualCQKnPT< DT , ST >::KNPLBnd( const int i )
 {
- return( A[ i ] );
+ return( Bnd( A[ i ] ) );
  }
 
 /*--------------------------------------------------------------------------*/
 
-inline double DualCQKnP::KNPUBnd( const int i )
+template< class DT , class ST >
+inline double DualCQKnPT< DT , ST >::KNPUBnd( const int i )
 {
- return( B[ i ] );
+ return( Bnd( B[ i ] ) );
  }
 
 /*--------------------------------------------------------------------------*/
 
-inline double DualCQKnP::KNPVlm( void )
+template< class DT , class ST >
+inline double DualCQKnPT< DT , ST >::KNPVlm( void )
 {
  return( McB );
  }
 
+/*--------------------------------------------------------------------------*/
+
+template< class DT , class ST >
+inline double DualCQKnPT< DT , ST >::Bnd( const DType b )
+{
+ if( sizeof( DType ) >= sizeof( double ) )  // Inf<double>() fits in DType
+  return( b );
+
+ if( b >= Inf<double>() )
+  return( Inf<double>() );
+
+ if( b <= - Inf<double>() )
+  return( - Inf<double>() );
+
+ return( b );
+ }
+
+/*--------------------------------------------------------------------------*/
+
+template< class DT , class ST >
+inline int DualCQKnPT< DT , ST >::Brk( const int k )
+{
+ if( k >= nSrtd )  // only with kLazyHeap
+  hpop( k );
+
+ return( I[ k ] );
+ }
+
+/*--------------------------------------------------------------------------*/
+
+template< class DT , class ST >
+inline void DualCQKnPT< DT , ST >::WrmPnt( const double mu , const SType beta ,
+					   const SType gamma , const int k )
+{
+ WMu = mu;
+ WBeta = beta;
+ WGamma = gamma;
+ WKInd = k;
+ }
+
+/*--------------------------------------------------------------------------*/
+
+template< class DT , class ST >
+inline void DualCQKnPT< DT , ST >::ChkBrkPnt( const double v ,
+					      const double mu ,
+					      const double muLo ,
+					      const double muHi , int &cL ,
+					      int &cR , double &bL ,
+					      double &bR )
+{
+ if( v < mu ) {
+  if( v > muLo )
+   cL++;
+  if( v > bL )
+   bL = v;
+  }
+ else
+  if( v > mu ) {
+   if( v < muHi )
+    cR++;
+   if( v < bR )
+    bR = v;
+   }
+ }
+
+/*--------------------------------------------------------------------------*/
+
+template< class DT , class ST >
+inline int DualCQKnPT< DT , ST >::ItemShp( const DType a , const DType b ,
+					   const DType d )
+{
+ const double INF = Inf<double>();
+
+ return( ( d > 0 ? ShpCnvx : 0 ) |
+	 ( ( a > - INF ) && ( b < INF ) ? ShpFnt : 0 ) |
+	 ( a == 0 ? ShpZLB : 0 ) );
+ }
+
 /*--------------------------------------------------------------------------*/
 
  };  // end( namespace KNPClass_di_unipi_it )
@@ -51,9 +51,12 @@ namespace CQKnPClass_di_unipi_it
 /** Continuous Quadratic Knapsack Problems (CQKnP) solver derived from the
     DualCQKnP class (and therefore from CQKnPClass) and extending it, using
     the same standard dual-ascent approach, to non-negative quadratic costs
-    and extended real bounds. */
+    and extended real bounds. Like DualCQKnPT it is a template over the type
+    of the data and of the sums, and ExDualCQKnP is the usual
+    ExDualCQKnPT< double , double >. */
 
-class ExDualCQKnP : public DualCQKnP {
+template< class DT , class ST >
+class ExDualCQKnPT : public DualCQKnPT< DT , ST > {
 
 /*--------------------------------------------------------------------------*/
 /*----------------------- PUBLIC PART OF THE CLASS -------------------------*/
@@ -66,13 +69,26 @@ class ExDualCQKnP : public DualCQKnP {
 
  public:
 
+/*--------------------------------------------------------------------------*/
+/*---------------------------- PUBLIC TYPES --------------------------------*/
+/*--------------------------------------------------------------------------*/
+/* Those of the base classes that are used here: the base class is a
+   template, hence they are not in scope. */
+
+  typedef typename DualCQKnPT< DT , ST >::SType SType;
+  typedef CQKnPClass::CQKException CQKException;
+  template< class T > using Inf = CQKnPClass::Inf< T >;
+
+  using DualCQKnPT< DT , ST >::kOK;
+
 /*--------------------------------------------------------------------------*/
 /*--------------------------- PUBLIC METHODS -------------------------------*/
 /*--------------------------------------------------------------------------*/
 /*---------------------------- CONSTRUCTOR ---------------------------------*/
 /*--------------------------------------------------------------------------*/
 
-   ExDualCQKnP( bool sort ) : DualCQKnP( sort ) {};
+   ExDualCQKnPT( int sort = DualCQKnPT< DT , ST >::kAutoSort )
+    : DualCQKnPT< DT , ST >( sort ) {};
 
 /*--------------------------------------------------------------------------*/
 /*---------------------- METHODS FOR READING RESULTS -----------------------*/
@@ -80,6 +96,8 @@ class ExDualCQKnP : public DualCQKnP {
 
    const double *KNPGetX( void );
 
+   using DualCQKnPT< DT , ST >::KNPGetX;  // the components one by one
+
 /*--------------------------------------------------------------------------*/
 /*--------------------- PROTECTED PART OF THE CLASS ------------------------*/
 /*--------------------------------------------------------------------------*/
@@ -95,8 +113,6 @@ class ExDualCQKnP : public DualCQKnP {
 /*-------------------------- PROTECTED METHODS -----------------------------*/
 /*--------------------------------------------------------------------------*/
 
-   bool CheckPFsb( void );
-
    bool CheckDFsb( void );
 
 /*--------------------------------------------------------------------------*/
@@ -111,11 +127,80 @@ class ExDualCQKnP : public DualCQKnP {
 
    void SetName( void );
 
-   void PreSort( void );
-
    void FindDualSol ( void );
 
- };  // end( class DualCQKnP )
+   void NewtonDualSol( void );
+
+   int ItemBrk( const int k , int *nm );
+
+   double ItemSol( const int k );
+
+   DualCQKnPT< DT , ST > *NewWrkr( void );
+
+/*--------------------------------------------------------------------------*/
+
+   template< bool CNVX , bool FNT , bool ZLB >
+    void GetXT( void );
+
+   template< bool CNVX , bool ZLB >
+    void FindDualT( void );
+
+   template< bool CNVX , bool FNT , bool ZLB >
+    void NewtonT( void );
+
+/* KNPGetX(), FindDualSol() and NewtonDualSol() only choose, according to
+   DualCQKnP::Shape, the version of GetXT(), FindDualT() and NewtonT() that
+   does the actual work. If CNVX, all the items have D[ k ] > 0, and the
+   code for the items with zero quadratic cost disappears (in GetXT(), also
+   the final loop leading phi'( muStar ) to 0, which has nothing to do); if
+   FNT, all the bounds are finite and they are not tested; if ZLB, all the
+   lower bounds are 0 and they are not even read. */
+
+/*--------------------------------------------------------------------------*/
+/*----------------------- PROTECTED DATA STRUCTURES  -----------------------*/
+/*--------------------------------------------------------------------------*/
+/* Those of the base class that are used here, see above. */
+
+  using DualCQKnPT< DT , ST >::n;
+  using DualCQKnPT< DT , ST >::status;
+
+  #if CQKnPClass_LOG
+  using DualCQKnPT< DT , ST >::KNPLog;
+  using DualCQKnPT< DT , ST >::KNPLLvl;
+  #endif
+
+  using DualCQKnPT< DT , ST >::A;
+  using DualCQKnPT< DT , ST >::B;
+  using DualCQKnPT< DT , ST >::C;
+  using DualCQKnPT< DT , ST >::D;
+  using DualCQKnPT< DT , ST >::Shape;
+  using DualCQKnPT< DT , ST >::ShpCnvx;
+  using DualCQKnPT< DT , ST >::ShpFnt;
+  using DualCQKnPT< DT , ST >::ShpZLB;
+  using DualCQKnPT< DT , ST >::McB;
+  using DualCQKnPT< DT , ST >::sense;
+  using DualCQKnPT< DT , ST >::LB;
+  using DualCQKnPT< DT , ST >::UB;
+  using DualCQKnPT< DT , ST >::I;
+  using DualCQKnPT< DT , ST >::nSort;
+  using DualCQKnPT< DT , ST >::OV;
+  using DualCQKnPT< DT , ST >::XSol;
+  using DualCQKnPT< DT , ST >::muStar;
+  using DualCQKnPT< DT , ST >::WSort;
+  using DualCQKnPT< DT , ST >::NrIter;
+  using DualCQKnPT< DT , ST >::OptVal;
+  using DualCQKnPT< DT , ST >::DefEps;
+  using DualCQKnPT< DT , ST >::Brk;
+  using DualCQKnPT< DT , ST >::ChkBrkPnt;
+  using DualCQKnPT< DT , ST >::ZeroDBnds;
+  using DualCQKnPT< DT , ST >::InitDer;
+  using DualCQKnPT< DT , ST >::WrmPnt;
+
+ };  // end( class ExDualCQKnPT )
+
+/*--------------------------------------------------------------------------*/
+
+typedef ExDualCQKnPT< double , double > ExDualCQKnP;
 
 /*--------------------------------------------------------------------------*/
 
@@ -0,0 +1,10 @@
+#!/bin/bash
+# runs the strong scaling test of MainPar.C (set MAIN = MainPar in the
+# makefile) on instances of increasing size, from 1 to all the cores
+# n mxthr nrep seed
+
+for n in 1000000 10000000 100000000; do
+
+./CQKnPSolve $n $(nproc) 3 1 || exit 1
+
+done
@@ -0,0 +1,17 @@
+#!/bin/bash
+# runs the tests of MainRnd.C (set MAIN = MainRnd in the makefile) on large
+# instances, where the O( n ) loops are limited by the memory bandwidth;
+# compare the times of builds with different DATA_TYPE and SUM_TYPE in
+# MainRnd.C (see DualCQKnPT in DualCQKnP.h), e.g. double double against
+# float double and long double long double; the CHECK_* of MainRnd.C can
+# be left on, as they compare the solvers on the data as they store it,
+# with a tolerance scaled to DATA_TYPE
+# nruns mx_size mn_size chgprc sr
+
+for mx_size in 10000000 1000000; do
+for chgprc in 1 0.01; do
+
+./CQKnPSolve 10 $mx_size $(( mx_size / 2 )) $chgprc 1 || exit 1
+
+done
+done
@@ -1,8 +1,8 @@
 # shell file for running tests on randomly-generated (CQKnP) instances
 # nruns mx_size mn_size chgprc sr
 
-set sr = 1
-# sorting procedure, default QS, change into sr = 0 for BS
+set sr = 5
+# sorting procedure, default adaptive, change into sr = 1 for QS, 0 for BS
 
 foreach mx_size ( 100000 10000 1000 100 )
 foreach chgprc ( 1 0.1 0.05 0.01 ) 
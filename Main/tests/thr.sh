@@ -0,0 +1,12 @@
+#!/bin/bash
+# runs the concurrent stress test of MainThr.C (set MAIN = MainThr in the
+# makefile) with all the sorting procedures and a few pool sizes
+# nruns nthr mx_size mn_size sort nreopt
+
+for sort in 5 1 3 2 0 4; do
+for nthr in 2 4 8; do
+
+./CQKnPSolve 200 $nthr 10000 100 $sort 4 || exit 1
+
+done
+done
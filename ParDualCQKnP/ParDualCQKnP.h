@@ -0,0 +1,285 @@
+/*--------------------------------------------------------------------------*/
+/*------------------------- File ParDualCQKnP.h ----------------------------*/
+/*--------------------------------------------------------------------------*/
+/** @file
+ *
+ * Continuous Quadratic Knapsack Problems (CQKnP) solver based on the
+ * standard dual approach, where the optimal multiplier of the knapsack
+ * constraint is found by rounds of multi-way selection of the breakpoints
+ * performed by many threads, each one working on its own share of them.
+ * It is derived from ExDualCQKnP, and therefore it supports non-negative
+ * quadratic costs and extended real bounds, fully conforming to the
+ * standard interface for CQKnP solver defined by the abstract base class
+ * CQKnpClass.
+ *
+ * \version 1.00
+ *
+ * \date 17 - 10 - 2026
+ */
+
+/*--------------------------------------------------------------------------*/
+/*----------------------------- DEFINITIONS --------------------------------*/
+/*--------------------------------------------------------------------------*/
+
+#ifndef __ParDualCQKnP
+ #define __ParDualCQKnP /* self-identification: #endif at the end of the file*/
+
+/*--------------------------------------------------------------------------*/
+/*------------------------------ INCLUDES ----------------------------------*/
+/*--------------------------------------------------------------------------*/
+
+#include "ExDualCQKnP.h"
+
+/*--------------------------------------------------------------------------*/
+/*------------------------- NAMESPACE and USING ----------------------------*/
+/*--------------------------------------------------------------------------*/
+
+namespace CQKnPClass_di_unipi_it
+{
+
+/*--------------------------------------------------------------------------*/
+/*---------------------------- CLASSES -------------------------------------*/
+/*--------------------------------------------------------------------------*/
+/** Continuous Quadratic Knapsack Problems (CQKnP) solver derived from the
+    ExDualCQKnP class (and therefore from CQKnPClass), which uses the same
+    data structures and the same construction of the primal solution, but
+    finds the optimal dual multiplier muStar by a selection approach that
+    uses many threads, meant for very large instances (n in the hundreds of
+    millions).
+
+    The breakpoints in I[] are split into a number of parts which only
+    depends on n (not on the number of threads), and the parts are shared
+    among the threads. The O( n ) computations of phi'() at the starting
+    point are done in the same way, on parts of the items. Then, at each
+    round up to 255 pivots are drawn among the breakpoints still in the
+    interval of uncertainty ( mu , muUB ); each thread computes, for each of
+    its parts, the contribution of the breakpoints of the part to phi'() at
+    all the pivots, and the partial sums of the parts are added up in the
+    order of the parts. This gives phi'() at all the pivots, hence the two
+    consecutive ones among which muStar lies; then, each thread moves the
+    breakpoints of its parts which are in the new interval in front of them,
+    and the next round only looks at these. The rounds stop when no
+    breakpoint is left in ( mu , muUB ), i.e., when phi'() is linear there.
+
+    Since each partial sum only depends on the content of its part, and
+    they are always added up in the same order, the result is exactly the
+    same (bit by bit) whatever the number of threads is. It is not exactly
+    the same as that of SelDualCQKnP, whose sums are accumulated in a
+    different order. The O( n ) work before FindDualSol() (the feasibility
+    checks and the computation of the breakpoints in PreSort()) is also
+    done in parallel, on parts of the blocks of items of DualCQKnP::Drt;
+    since the results of the blocks are added up in order by one thread,
+    they are the same as in ExDualCQKnP. KNPGetX() is done by one thread.
+    All of this runs on the threads started by SetThreads(). Like SelDualCQKnP, this cannot exploit the information of
+    previous solutions when reoptimizing. Like ExDualCQKnPT it is a template
+    over the type of the data and of the sums, and ParDualCQKnP is the usual
+    ParDualCQKnPT< double , double >. */
+
+template< class DT , class ST >
+class ParDualCQKnPT : public ExDualCQKnPT< DT , ST > {
+
+/*--------------------------------------------------------------------------*/
+/*----------------------- PUBLIC PART OF THE CLASS -------------------------*/
+/*--------------------------------------------------------------------------*/
+/*--                                                                      --*/
+/*--  The following methods and data are the actual interface of the      --*/
+/*--  class: the standard user should use these methods and data only.    --*/
+/*--                                                                      --*/
+/*--------------------------------------------------------------------------*/
+
+ public:
+
+/*--------------------------------------------------------------------------*/
+/*---------------------------- PUBLIC TYPES --------------------------------*/
+/*--------------------------------------------------------------------------*/
+/* Those of the base classes that are used here, see ExDualCQKnPT. */
+
+  typedef typename ExDualCQKnPT< DT , ST >::SType SType;
+  template< class T > using Inf = CQKnPClass::Inf< T >;
+
+  using ExDualCQKnPT< DT , ST >::kOK;
+
+  using ExDualCQKnPT< DT , ST >::SetEps;
+  using ExDualCQKnPT< DT , ST >::SetThreads;
+
+/*--------------------------------------------------------------------------*/
+/*--------------------------- PUBLIC METHODS -------------------------------*/
+/*--------------------------------------------------------------------------*/
+/*---------------------------- CONSTRUCTOR ---------------------------------*/
+/*--------------------------------------------------------------------------*/
+
+   ParDualCQKnPT( const int NThr = 0 , const double eps = 1e-6 );
+
+/**< NThr is the maximum number of threads used by FindDualSol(), and it is
+   passed to SetThreads() (so that it is also used by SolveBatch()); if
+   NThr == 0, the number of cores of the machine is used. Whatever NThr is,
+   instances with less than a few tens of thousands of items are solved by
+   one thread, since each part of the breakpoints must be large enough to
+   be worth a thread. Threads are only used if DualCQKnP_PARALLEL == 1;
+   they are those started by SetThreads(), hence reoptimizing allocates no
+   memory (see DualCQKnP::Reserve()).
+   The parameter eps defines the precision required to construct the
+   solution, see DualCQKnP. As in SelDualCQKnP, kNewton selects the Newton
+   method of ExDualCQKnP while the other sorting procedures are irrelevant.
+   The number of selection rounds of the last call to SolveKNP() is returned
+   by KNPGetIter(). */
+
+/*--------------------------------------------------------------------------*/
+/*------------------------------ DESTRUCTOR --------------------------------*/
+/*--------------------------------------------------------------------------*/
+
+   virtual ~ParDualCQKnPT();
+
+/*--------------------------------------------------------------------------*/
+/*--------------------- PROTECTED PART OF THE CLASS ------------------------*/
+/*--------------------------------------------------------------------------*/
+/*--                                                                      --*/
+/*-- Nobody should ever look at this part: everything that is under this  --*/
+/*-- advice may be changed without notice in any new release of the code. --*/
+/*--                                                                      --*/
+/*--------------------------------------------------------------------------*/
+
+ protected:
+
+/*--------------------------------------------------------------------------*/
+/*-------------------------- PROTECTED METHODS -----------------------------*/
+/*--------------------------------------------------------------------------*/
+
+   bool CheckPFsb( void );
+
+   bool CheckDFsb( void );
+
+   void PreSort( void );
+
+/* The same as in ExDualCQKnP, but the blocks of items that have changed
+   are recomputed in parallel, see DualCQKnP::SumBndsP(). */
+
+   void Sort( void );
+
+   void FindDualSol ( void );
+
+   bool WarmDualSol( void ) { return( false ); }
+
+   void SaveDualSol( void ) {}
+
+/* Since FindDualSol() does not sort I[], the previous optimal solution
+   cannot be used to warm-start the next call. */
+
+   DualCQKnPT< DT , ST > *NewWrkr( void ) {
+    return( new ParDualCQKnPT( 1 ) );
+    }
+
+/* The workers of SolveBatch() already run in parallel, hence each of them
+   uses one thread. */
+
+/*--------------------------------------------------------------------------*/
+/*----------------------- PROTECTED DATA STRUCTURES  -----------------------*/
+/*--------------------------------------------------------------------------*/
+/* Those of the base class that are used here, see above. */
+
+  using ExDualCQKnPT< DT , ST >::n;
+  using ExDualCQKnPT< DT , ST >::status;
+  using ExDualCQKnPT< DT , ST >::ShpCnvx;
+
+  #if CQKnPClass_LOG
+  using ExDualCQKnPT< DT , ST >::KNPLog;
+  using ExDualCQKnPT< DT , ST >::KNPLLvl;
+  #endif
+
+  using ExDualCQKnPT< DT , ST >::A;
+  using ExDualCQKnPT< DT , ST >::B;
+  using ExDualCQKnPT< DT , ST >::C;
+  using ExDualCQKnPT< DT , ST >::D;
+  using ExDualCQKnPT< DT , ST >::McB;
+  using ExDualCQKnPT< DT , ST >::Shape;
+  using ExDualCQKnPT< DT , ST >::LB;
+  using ExDualCQKnPT< DT , ST >::UB;
+  using ExDualCQKnPT< DT , ST >::I;
+  using ExDualCQKnPT< DT , ST >::nSort;
+  using ExDualCQKnPT< DT , ST >::SrtdI;
+  using ExDualCQKnPT< DT , ST >::OV;
+  using ExDualCQKnPT< DT , ST >::muStar;
+  using ExDualCQKnPT< DT , ST >::NrIter;
+  using ExDualCQKnPT< DT , ST >::OptVal;
+  using ExDualCQKnPT< DT , ST >::NThrds;
+
+/*--------------------------------------------------------------------------*/
+/*--------------------- PRIVATE PART OF THE CLASS ------------------------*/
+/*--------------------------------------------------------------------------*/
+
+ private:
+
+/*--------------------------------------------------------------------------*/
+/*-------------------------- PRIVATE METHODS -------------------------------*/
+/*--------------------------------------------------------------------------*/
+
+   void SetParts( void );  // compute NPrt and the parts of I[]
+
+   void PRun( void ( ParDualCQKnPT::*f )( const int ) );  // all the parts
+
+   void PRange( void ( ParDualCQKnPT::*f )( const int ) ,
+		const int t , const int nT );  // the parts of thread t
+
+   static void PCall( const int t , void *arg );  // PRange() for ThrdRun()
+
+   void PSumBnds( const int p );  // SumBndsP() for the p-th part
+
+   void PZeroDBnds( const int p );  // ZeroDBndsP() for the p-th part
+
+   void PPreSort( const int p );  // PreSortP() for the p-th part
+
+   void MinBrk( const int p );  // the smallest breakpoint of part p
+
+   void LinSums( const int p );  // phi'() when it is linear everywhere
+
+   void DerSums( const int p );  // phi'( PMu - ) or phi'( PMu + )
+
+   void Select( const int p );  // keep the breakpoints in ( PMu , PUB )
+
+   void PvtSums( const int p );  // the variation of phi'() at the pivots
+
+/* Each of these computes something for the p-th part (of I[], or of the
+   items), and writes it in the p-th row of PSum[], if needed. */
+
+/*--------------------------------------------------------------------------*/
+/*----------------------- PRIVATE DATA STRUCTURES  -------------------------*/
+/*--------------------------------------------------------------------------*/
+
+  int NPrt;         ///< number of parts of the current call
+  int PAlc;         ///< number of parts for which memory is allocated
+  int *PBeg;        ///< the breakpoints of part p are ...
+  int *PEnd;        ///< ... I[ PBeg[ p ] .. PEnd[ p ] )
+  int *PPre;        ///< how many breakpoints are in parts 0 .. p - 1
+  SType *PSum;      ///< the partial sums of each part, one row each
+
+  double *Pvt;      ///< the pivots of the current round, ordered
+  int nPvt;         ///< how many they are
+  double PRef;      ///< the reference point of the sums at the pivots
+
+  double PMu;       ///< the current mu
+  double PUB;       ///< the current upper bound on muStar
+  bool PRgt;        ///< true if DerSums() computes phi'( PMu + )
+
+  unsigned int RndSd;  ///< seed of the generator choosing the pivots
+
+  void ( ParDualCQKnPT::*PFn )( const int );  ///< what PRun() runs ...
+  int PNT;          ///< ... and with how many threads
+
+ };  // end( class ParDualCQKnPT )
+
+/*--------------------------------------------------------------------------*/
+
+typedef ParDualCQKnPT< double , double > ParDualCQKnP;
+
+/*--------------------------------------------------------------------------*/
+
+ };  // end( namespace KNPClass_di_unipi_it )
+
+/*--------------------------------------------------------------------------*/
+/*--------------------------------------------------------------------------*/
+
+#endif  /* ParDualCQKnP.h included */
+
+/*--------------------------------------------------------------------------*/
+/*----------------------- End File ParDualCQKnP.h --------------------------*/
+/*--------------------------------------------------------------------------*/
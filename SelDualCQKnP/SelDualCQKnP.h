@@ -0,0 +1,187 @@
+/*--------------------------------------------------------------------------*/
+/*------------------------- File SelDualCQKnP.h ----------------------------*/
+/*--------------------------------------------------------------------------*/
+/** @file
+ *
+ * Continuous Quadratic Knapsack Problems (CQKnP) solver based on the
+ * standard dual approach, where the optimal multiplier of the knapsack
+ * constraint is found by repeated selection of the median breakpoint rather
+ * than by fully sorting all of them. It is derived from ExDualCQKnP, and
+ * therefore it supports non-negative quadratic costs and extended real
+ * bounds, fully conforming to the standard interface for CQKnP solver
+ * defined by the abstract base class CQKnpClass.
+ *
+ * \version 1.00
+ *
+ * \date 17 - 10 - 2026
+ */
+
+/*--------------------------------------------------------------------------*/
+/*----------------------------- DEFINITIONS --------------------------------*/
+/*--------------------------------------------------------------------------*/
+
+#ifndef __SelDualCQKnP
+ #define __SelDualCQKnP /* self-identification: #endif at the end of the file*/
+
+/*--------------------------------------------------------------------------*/
+/*------------------------------ INCLUDES ----------------------------------*/
+/*--------------------------------------------------------------------------*/
+
+#include "ExDualCQKnP.h"
+
+/*--------------------------------------------------------------------------*/
+/*------------------------- NAMESPACE and USING ----------------------------*/
+/*--------------------------------------------------------------------------*/
+
+namespace CQKnPClass_di_unipi_it
+{
+
+/*--------------------------------------------------------------------------*/
+/*---------------------------- CLASSES -------------------------------------*/
+/*--------------------------------------------------------------------------*/
+/** Continuous Quadratic Knapsack Problems (CQKnP) solver derived from the
+    ExDualCQKnP class (and therefore from CQKnPClass), which uses the same
+    data structures and the same construction of the primal solution, but
+    finds the optimal dual multiplier muStar by a selection approach in the
+    style of Brucker and Kiwiel.
+
+    The derivative phi'( mu ) of the dual function is a nonincreasing
+    piecewise-linear function whose breakpoints are the 2 * n values
+    2 * A[ i ] * D[ i ] + C[ i ] and 2 * B[ i ] * D[ i ] + C[ i ] (or C[ i ]
+    for the items with zero quadratic cost). Rather than sorting them all,
+    which costs O( n lg n ), a random breakpoint is picked as pivot among the
+    ones still in the interval of uncertainty, phi'() is computed at the
+    pivot by only looking at the breakpoints in the interval, and the half
+    of the interval not containing muStar is discarded together with all the
+    breakpoints it contains. This is expected O( n ), and typically faster
+    than DualCQKnP / ExDualCQKnP when the problem is solved "from scratch",
+    while it cannot exploit the information of previous solutions when
+    reoptimizing after small changes in the data. Like ExDualCQKnPT it is a
+    template over the type of the data and of the sums, and SelDualCQKnP is
+    the usual SelDualCQKnPT< double , double >. */
+
+template< class DT , class ST >
+class SelDualCQKnPT : public ExDualCQKnPT< DT , ST > {
+
+/*--------------------------------------------------------------------------*/
+/*----------------------- PUBLIC PART OF THE CLASS -------------------------*/
+/*--------------------------------------------------------------------------*/
+/*--                                                                      --*/
+/*--  The following methods and data are the actual interface of the      --*/
+/*--  class: the standard user should use these methods and data only.    --*/
+/*--                                                                      --*/
+/*--------------------------------------------------------------------------*/
+
+ public:
+
+/*--------------------------------------------------------------------------*/
+/*---------------------------- PUBLIC TYPES --------------------------------*/
+/*--------------------------------------------------------------------------*/
+/* Those of the base classes that are used here, see ExDualCQKnPT. */
+
+  typedef typename ExDualCQKnPT< DT , ST >::SType SType;
+  template< class T > using Inf = CQKnPClass::Inf< T >;
+
+  using ExDualCQKnPT< DT , ST >::kOK;
+
+  using ExDualCQKnPT< DT , ST >::SetEps;
+
+/*--------------------------------------------------------------------------*/
+/*--------------------------- PUBLIC METHODS -------------------------------*/
+/*--------------------------------------------------------------------------*/
+/*---------------------------- CONSTRUCTOR ---------------------------------*/
+/*--------------------------------------------------------------------------*/
+
+   SelDualCQKnPT( const double eps = 1e-6 )
+    : ExDualCQKnPT< DT , ST >( DualCQKnPT< DT , ST >::kQuickSort ) {
+    // any sort would do, since Sort() does nothing here
+    SetEps( eps );
+    RndSd = 1;
+    }
+
+/**< The parameter eps defines the precision required to construct the
+   solution, see DualCQKnP. Since no sorting is performed, choosing between
+   kBubbleSort and kQuickSort with SetSort() is irrelevant for this class,
+   while kNewton selects the Newton method of ExDualCQKnP instead. The
+   number of selection rounds (each costing O( n ) in the worst case) of the
+   last call to SolveKNP() is returned by KNPGetIter(). */
+
+/*--------------------------------------------------------------------------*/
+/*--------------------- PROTECTED PART OF THE CLASS ------------------------*/
+/*--------------------------------------------------------------------------*/
+/*--                                                                      --*/
+/*-- Nobody should ever look at this part: everything that is under this  --*/
+/*-- advice may be changed without notice in any new release of the code. --*/
+/*--                                                                      --*/
+/*--------------------------------------------------------------------------*/
+
+ protected:
+
+/*--------------------------------------------------------------------------*/
+/*-------------------------- PROTECTED METHODS -----------------------------*/
+/*--------------------------------------------------------------------------*/
+
+   void Sort( void );
+
+   void FindDualSol ( void );
+
+   bool WarmDualSol( void ) { return( false ); }
+
+   void SaveDualSol( void ) {}
+
+/* Since FindDualSol() does not sort I[], the previous optimal solution
+   cannot be used to warm-start the next call. */
+
+   DualCQKnPT< DT , ST > *NewWrkr( void ) {
+    return( new SelDualCQKnPT() );
+    }
+
+/*--------------------------------------------------------------------------*/
+/*----------------------- PROTECTED DATA STRUCTURES  -----------------------*/
+/*--------------------------------------------------------------------------*/
+
+  unsigned int RndSd;  ///< seed of the generator choosing the pivots
+
+/* Those of the base class that are used here, see above. */
+
+  using ExDualCQKnPT< DT , ST >::n;
+  using ExDualCQKnPT< DT , ST >::status;
+
+  #if CQKnPClass_LOG
+  using ExDualCQKnPT< DT , ST >::KNPLog;
+  using ExDualCQKnPT< DT , ST >::KNPLLvl;
+  #endif
+
+  using ExDualCQKnPT< DT , ST >::A;
+  using ExDualCQKnPT< DT , ST >::B;
+  using ExDualCQKnPT< DT , ST >::C;
+  using ExDualCQKnPT< DT , ST >::D;
+  using ExDualCQKnPT< DT , ST >::McB;
+  using ExDualCQKnPT< DT , ST >::LB;
+  using ExDualCQKnPT< DT , ST >::UB;
+  using ExDualCQKnPT< DT , ST >::I;
+  using ExDualCQKnPT< DT , ST >::nSort;
+  using ExDualCQKnPT< DT , ST >::SrtdI;
+  using ExDualCQKnPT< DT , ST >::OV;
+  using ExDualCQKnPT< DT , ST >::muStar;
+  using ExDualCQKnPT< DT , ST >::NrIter;
+  using ExDualCQKnPT< DT , ST >::OptVal;
+
+ };  // end( class SelDualCQKnPT )
+
+/*--------------------------------------------------------------------------*/
+
+typedef SelDualCQKnPT< double , double > SelDualCQKnP;
+
+/*--------------------------------------------------------------------------*/
+
+ };  // end( namespace KNPClass_di_unipi_it )
+
+/*--------------------------------------------------------------------------*/
+/*--------------------------------------------------------------------------*/
+
+#endif  /* SelDualCQKnP.h included */
+
+/*--------------------------------------------------------------------------*/
+/*----------------------- End File SelDualCQKnP.h --------------------------*/
+/*--------------------------------------------------------------------------*/
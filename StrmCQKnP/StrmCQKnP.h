@@ -0,0 +1,322 @@
+/*--------------------------------------------------------------------------*/
+/*-------------------------- File StrmCQKnP.h ------------------------------*/
+/*--------------------------------------------------------------------------*/
+/** @file
+ *
+ * Continuous Quadratic Knapsack Problems (CQKnP) solver for the instances
+ * which do not fit in memory. The data is never stored as a whole: it is
+ * read from the file (in either the text or the binary format of
+ * CQKnPClass) a chunk of items at a time, each time the optimal multiplier
+ * of the knapsack constraint needs some information about it, and the
+ * primal solution is written to another file in the same way.
+ *
+ * \version 1.00
+ *
+ * \date 17 - 10 - 2026
+ */
+
+/*--------------------------------------------------------------------------*/
+/*----------------------------- DEFINITIONS --------------------------------*/
+/*--------------------------------------------------------------------------*/
+
+#ifndef __StrmCQKnP
+ #define __StrmCQKnP /* self-identification: #endif at the end of the file */
+
+/*--------------------------------------------------------------------------*/
+/*------------------------------ INCLUDES ----------------------------------*/
+/*--------------------------------------------------------------------------*/
+
+#include "CQKnPClass.h"
+
+/*--------------------------------------------------------------------------*/
+/*------------------------- NAMESPACE and USING ----------------------------*/
+/*--------------------------------------------------------------------------*/
+
+namespace CQKnPClass_di_unipi_it
+{
+
+/*--------------------------------------------------------------------------*/
+/*---------------------------- CLASSES -------------------------------------*/
+/*--------------------------------------------------------------------------*/
+/** Continuous Quadratic Knapsack Problems (CQKnP) solver which keeps in
+    memory only a chunk of the items at a time, plus a number of other
+    values which does not depend on the size of the instance. Since the
+    CQKnPClass interface is built on vectors of n elements (the data given
+    to LoadSet() and the solution returned by KNPGetX()), the class is not
+    derived from it, but it solves the same problem: all the items have
+    finite linear costs and non-negative finite quadratic costs, the bounds
+    may be infinite, and the knapsack constraint may be either an equality
+    or a <= one.
+
+    The optimal multiplier muStar of the knapsack constraint is found as in
+    SelDualCQKnP, except that each selection round is a pass over the file:
+    phi'( mu ) (and its jump, if any) is computed at up to 255 pivots at a
+    time, which are randomly sampled among the breakpoints in the current
+    interval of uncertainty. The pass also counts and samples the
+    breakpoints in each of the intervals between two pivots, so that the
+    next round starts with the pivots of the interval which contains
+    muStar. This is a multisection rather than a bisection, and it needs
+    O( log( n ) / log( 256 ) ) passes rather than O( log( n ) ) ones. As
+    soon as the breakpoints in the interval fit in a chunk, one last pass
+    collects them, and muStar is found by sorting them as in DualCQKnP.
+
+    The items with zero quadratic cost whose breakpoint is muStar may take
+    any value between their bounds: all those with finite bounds get the
+    same fraction of B[ i ] - A[ i ], and the first one with an infinite
+    bound (if any) takes what remains, so that the primal solution can be
+    written in one pass. */
+
+class StrmCQKnP {
+
+/*--------------------------------------------------------------------------*/
+/*----------------------- PUBLIC PART OF THE CLASS -------------------------*/
+/*--------------------------------------------------------------------------*/
+/*--                                                                      --*/
+/*--  The following methods and data are the actual interface of the      --*/
+/*--  class: the standard user should use these methods and data only.    --*/
+/*--                                                                      --*/
+/*--------------------------------------------------------------------------*/
+
+ public:
+
+/*--------------------------------------------------------------------------*/
+/*---------------------------- PUBLIC TYPES --------------------------------*/
+/*--------------------------------------------------------------------------*/
+
+  typedef long double SType;  ///< type of the sums over the items
+
+/*--------------------------------------------------------------------------*/
+/*--------------------------- PUBLIC METHODS -------------------------------*/
+/*--------------------------------------------------------------------------*/
+/*---------------------------- CONSTRUCTOR ---------------------------------*/
+/*--------------------------------------------------------------------------*/
+
+   StrmCQKnP( const int chnk = 1 << 16 );
+
+/**< The parameter chnk is the number of items which are read (and written)
+   at a time. The memory used by the object is about 56 * chnk bytes, plus
+   64 * chnk to read the text format and 25 * chnk to write the solution in
+   text, plus about 0.5 MB for the sampled breakpoints, whatever the size
+   of the instance. */
+
+/*--------------------------------------------------------------------------*/
+/*-------------------------- OTHER INITIALIZATIONS -------------------------*/
+/*--------------------------------------------------------------------------*/
+
+   void LoadFile( const char *fName , const bool RBV = false );
+
+/**< Sets the instance to be the one in the file with name fName, which is
+   in the binary format of CQKnPClass::WriteInstanceBinary() if
+   CQKnPClass::IsBinaryInstance( fName ) says so, and in the text format of
+   CQKnPClass::ReadInstance() otherwise (RBV having the same meaning as
+   there, and being ignored for the binary format). The data is read and
+   checked as CQKnPClass::ReadInstance() does, throwing CQKException if
+   anything is wrong, and meanwhile the breakpoints are sampled for the
+   first round of SolveKNP(). The file is kept open (and it must not
+   change) until the next call to LoadFile() or the object is destroyed.
+
+   The text format is read from four positions at a time, one for each of
+   the n-vectors, which are found by a first pass over the file that only
+   counts the numbers. */
+
+/*--------------------------------------------------------------------------*/
+/*-------------------- METHODS FOR SOLVING THE PROBLEM ---------------------*/
+/*--------------------------------------------------------------------------*/
+
+   CQKnPClass::CQKStatus SolveKNP( void );
+
+/**< Solves the current instance, returning kOK, kUnfeasible or kUnbounded
+   with the same meaning as in CQKnPClass::SolveKNP(). Only muStar is found
+   here, see WriteX() for the primal solution. */
+
+/*--------------------------------------------------------------------------*/
+/*---------------------- METHODS FOR READING RESULTS -----------------------*/
+/*--------------------------------------------------------------------------*/
+
+   double KNPGetPi( void ) { return( muStar ); }
+
+/**< Returns the optimal multiplier of the knapsack constraint, with the same
+   sign convention as CQKnPClass::KNPGetPi(). */
+
+/*--------------------------------------------------------------------------*/
+
+   void WriteX( const char *fName , const bool bin = false );
+
+/**< Makes a pass over the file of the instance to compute the optimal
+   primal solution, which is written in the file with name fName: in text,
+   one number per line (each with as many digits as needed to read it back
+   exactly), if bin == false, as n doubles in the byte order of the machine
+   otherwise. The optimal value is computed at the same time, see
+   KNPGetFO(). fName == 0 means that the solution is not written. */
+
+/*--------------------------------------------------------------------------*/
+
+   double KNPGetFO( void );
+
+/**< Returns the objective function value of the optimal solution, that is
+   INF if SolveKNP() has returned kUnfeasible and - INF if it has returned
+   kUnbounded. If WriteX() has not been called yet, this costs one pass over
+   the file. */
+
+/*--------------------------------------------------------------------------*/
+/*------------------- METHODS FOR READING THE DATA -------------------------*/
+/*--------------------------------------------------------------------------*/
+
+   int KNPn( void ) { return( n ); }
+
+/**< Returns the number of items of the current instance. */
+
+/*--------------------------------------------------------------------------*/
+
+   int KNPGetPasses( void ) { return( NPass ); }
+
+/**< Returns how many passes over the file of the instance have been done
+   since the last call to LoadFile() (including those of LoadFile()
+   itself). */
+
+/*--------------------------------------------------------------------------*/
+/*------------------------------ DESTRUCTOR --------------------------------*/
+/*--------------------------------------------------------------------------*/
+
+   ~StrmCQKnP();
+
+/*--------------------------------------------------------------------------*/
+/*--------------------- PROTECTED PART OF THE CLASS ------------------------*/
+/*--------------------------------------------------------------------------*/
+/*--                                                                      --*/
+/*-- Nobody should ever look at this part: everything that is under this  --*/
+/*-- advice may be changed without notice in any new release of the code. --*/
+/*--                                                                      --*/
+/*--------------------------------------------------------------------------*/
+
+ protected:
+
+/*--------------------------------------------------------------------------*/
+/*--------------------------- PROTECTED TYPES ------------------------------*/
+/*--------------------------------------------------------------------------*/
+
+  struct TxtCrsr {
+   char *Buf;      ///< the buffer
+   size_t Pos;     ///< the first character of Buf[] still to be read
+   size_t End;     ///< the first character of Buf[] not read from the file
+   off_t FPos;     ///< the position in the file of Buf[ End ]
+   bool Eof;       ///< true if the end of the file is in Buf[]
+   };
+
+/**< Reads the numbers in the text format from a position of the file,
+   through a buffer of TBSz characters. */
+
+  struct Event {
+   double v;       ///< the breakpoint
+   double dg;      ///< the variation of the rate of phi'() in v
+   double jb;      ///< the jump of phi'() in v
+   };
+
+/**< A breakpoint of phi'(), as collected by the last pass of SolveKNP(). */
+
+/*--------------------------------------------------------------------------*/
+/*-------------------------- PROTECTED METHODS -----------------------------*/
+/*--------------------------------------------------------------------------*/
+
+   template< class F >
+   const char *Scan( F f );
+
+/**< Makes a pass over the file of the instance, calling f( m ) after each
+   chunk of m items has been read in C[], D[], A[] and B[]. Returns 0 if
+   the whole file has been read, and an error message otherwise. */
+
+   bool Next( TxtCrsr &tc , double &x );
+
+/**< Reads in x the next number of tc, returning false if there is none. */
+
+   void Restart( TxtCrsr &tc , const off_t pos );
+
+/**< Makes tc read the numbers from position pos of the file. */
+
+   void Round( const int m );
+
+/**< Computes the contribution of the m items in the chunk to phi'() and to
+   its jump at the NP pivots in Pvt[], and counts and samples the
+   breakpoints of the items in each of the intervals between them. */
+
+   void Sample( const double v , const int j );
+
+/**< Counts and samples the breakpoint v, which belongs to the j-th
+   interval of Round(), if it is in ( ML , MR ) and it is not a pivot. */
+
+   bool Decide( bool FlgL , bool FlgU );
+
+/**< Uses the results of Round() either to find muStar at one of the pivots
+   (returning true) or to restrict ( ML , MR ) and choose the next pivots
+   (returning false). FlgL and FlgU mean that the first and the last pivot
+   are ML and MR. */
+
+   CQKnPClass::CQKStatus Walk( void );
+
+/**< The last pass of SolveKNP(): collects the breakpoints in ( ML , MR ) and
+   finds muStar among them. It only returns kOK, since SolveKNP() has
+   already decided the feasibility of the instance. */
+
+/*--------------------------------------------------------------------------*/
+/*----------------------- PROTECTED DATA STRUCTURES  -----------------------*/
+/*--------------------------------------------------------------------------*/
+
+  int CSz;             ///< the number of items in a chunk
+  size_t TBSz;         ///< the size of the buffer of a TxtCrsr
+  int n;               ///< the number of items
+  double V;            ///< the volume of the knapsack
+  bool sense;          ///< true for an equality constraint
+
+  int fd;              ///< the file of the instance (-1 if none)
+  bool Bin;            ///< true if it is in the binary format
+  bool RdBV;           ///< true if a text file has the bounds and the volume
+  off_t Off[ 5 ];      ///< where C[], D[], A[], B[] and V begin in the file
+  TxtCrsr Crsr[ 4 ];   ///< the readers of C[], D[], A[] and B[] (text)
+
+  double *C;           ///< the chunk of linear costs
+  double *D;           ///< the chunk of quadratic costs
+  double *A;           ///< the chunk of lower bounds
+  double *B;           ///< the chunk of upper bounds
+
+  int NPass;           ///< number of passes over the file
+  CQKnPClass::CQKStatus status;  ///< the status of the last SolveKNP()
+
+  double LB;           ///< muStar is >= LB ...
+  double UB;           ///< ... and <= UB
+  SType SumA;          ///< the sum of the finite lower bounds
+  SType SumB;          ///< the sum of the finite upper bounds
+  bool InfA;           ///< true if some lower bound is - INF
+  bool InfB;           ///< true if some upper bound is + INF
+
+  double muStar;       ///< the optimal multiplier
+  double Theta;        ///< the fraction of the items tied at muStar
+  SType Res;           ///< what the first infinite item tied at muStar takes
+  SType OptVal;        ///< the optimal value (INF if not computed yet)
+
+  double ML;           ///< the interval ( ML , MR ) where muStar is ...
+  double MR;           ///< ... and whose breakpoints are sampled
+  double Ref;          ///< the reference point of the pivot phase
+  long long NBrk;      ///< the breakpoints in ( ML , MR ) (-1 = unknown)
+  int NP;              ///< the number of pivots
+  double *Pvt;         ///< the pivots, ordered
+  SType *dK;           ///< difference array of the constant part of phi'()
+  SType *dG;           ///< difference array of the rate of phi'()
+  SType *Jmp;          ///< the jump of phi'() at each pivot
+  long long *Cnt;      ///< the breakpoints in each interval
+  double *Rsv;         ///< the sampled breakpoints of each interval
+  unsigned long long RndSd;  ///< seed of the generator of the samples
+
+ };  // end( class StrmCQKnP )
+
+/*--------------------------------------------------------------------------*/
+
+ };  // end( namespace CQKnPClass_di_unipi_it )
+
+/*--------------------------------------------------------------------------*/
+/*--------------------------------------------------------------------------*/
+
+#endif  /* StrmCQKnP.h included */
+
+/*--------------------------------------------------------------------------*/
+/*------------------------ End File StrmCQKnP.h ----------------------------*/
+/*--------------------------------------------------------------------------*/